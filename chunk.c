@@ -71,7 +71,7 @@ int http_parse_chunked(int* state, int *size, char ch)
         break;
 
     case 0x83:
-        return *size == 0;
+        return 0;
     }
 
     return 1;
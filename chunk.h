@@ -36,8 +36,10 @@ extern "C" {
  * needs more data. Retuns zero success or error. When error: size == -1 On
  * success, size = size of following chunk data excluding trailing \r\n. User is
  * expected to process or otherwise seek past chunk data up to the trailing
- * \r\n. The state parameter is used for internal state and should be
- * initialized to zero the first call.
+ * \r\n. A size of zero marks the last chunk, which is followed by the
+ * (possibly empty) trailer section; see http_header_initial_fields. The state
+ * parameter is used for internal state and should be initialized to zero the
+ * first call.
  */
 int http_parse_chunked(int* state, int *size, char ch);
 
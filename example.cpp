@@ -50,49 +50,38 @@ extern "C" {
 	#include "chunk.c"
 }
 
-// return a socket connected to a hostname, or -1
+// return a socket connected to a hostname, or -1. each resolved address
+// (IPv4 or IPv6) is tried in the order returned by the resolver
 int connectsocket(const char* host, int port)
 {
-
+    addrinfo hints;
     addrinfo* result = NULL;
-    sockaddr_in addr = {0};
-    int s;
+    char service[16];
+    int s = -1;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    snprintf(service, sizeof(service), "%d", port);
 
-    if (getaddrinfo(host, NULL, NULL, &result))
-        goto error;
+    if (getaddrinfo(host, service, &hints, &result))
+        return -1;
 
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    addr.sin_addr.s_addr = INADDR_ANY;
     for (addrinfo* ai = result; ai != NULL; ai = ai->ai_next) {
-        if (ai->ai_family != AF_INET)
+        s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == -1)
             continue;
 
-        const sockaddr_in *ai_in = (const sockaddr_in*)ai->ai_addr;
-        addr.sin_addr = ai_in->sin_addr;
-        break;
+        if (connect(s, ai->ai_addr, ai->ai_addrlen) == 0)
+            break;
+
+        close(s);
+        s = -1;
     }
 
     freeaddrinfo(result);
-
-    if (addr.sin_addr.s_addr == INADDR_ANY)
-        goto error;
-
-    s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (s == -1)
-        goto error;
-
-    if (connect(s, (const sockaddr*)&addr, sizeof(addr)))
-        goto error;
-
     return s;
-
-error:
-    if (s != -1)
-        close(s);
-    if (result)
-        freeaddrinfo(result);
-    return -1;
 }
 
 // Response data/funcs
@@ -128,18 +117,39 @@ static const http_funcs responseFuncs = {
     response_code,
 };
 
-int main()
+int main(int argc, char* argv[])
 {
+    // usage: example [host [port [path]]]
+    const char* host = argc > 1 ? argv[1] : "nothings.org";
+    const char* path = argc > 3 ? argv[3] : "/";
+    int port = 80;
+    if (argc > 2) {
+        char* end;
+        const long lport = strtol(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || lport < 1 || lport > 65535) {
+            fprintf(stderr, "usage: %s [host [port [path]]]\n", argv[0]);
+            return -1;
+        }
+        port = (int)lport;
+    }
+
+    // Host must match the authority: bracket IPv6 literals, add a non-default port
+    std::string hostheader = strchr(host, ':') ? std::string("[") + host + "]" : std::string(host);
+    if (port != 80) {
+        char portstr[16];
+        snprintf(portstr, sizeof(portstr), ":%d", port);
+        hostheader += portstr;
+    }
 
-    int conn = connectsocket("nothings.org", 80);
+    int conn = connectsocket(host, port);
     if (conn < 0) {
         fprintf(stderr, "Failed to connect socket\n");
         return -1;
     }
 
-    const char request[] = "GET / HTTP/1.0\r\nContent-Length: 0\r\n\r\n";
-    int len = send(conn, request, sizeof(request) - 1, 0);
-    if (len != sizeof(request) - 1) {
+    const std::string request = std::string("GET ") + path + " HTTP/1.0\r\nHost: " + hostheader + "\r\nContent-Length: 0\r\n\r\n";
+    int len = send(conn, request.data(), request.size(), 0);
+    if (len != (int)request.size()) {
         fprintf(stderr, "Failed to send request\n");
         close(conn);
         return -1;
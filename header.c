@@ -26,7 +26,7 @@
 
 #include "header.h"
 
-static unsigned char http_header_state[] = {
+static const unsigned char http_header_state[] = {
 /*     *    \t    \n   \r    ' '     ,     :   PAD */
     0x80,    1, 0xC1, 0xC1,    1, 0x80, 0x80, 0xC1, /* state 0: HTTP version */
     0x81,    2, 0xC1, 0xC1,    2,    1,    1, 0xC1, /* state 1: Response code */
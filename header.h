@@ -43,6 +43,17 @@ enum http_header_status
     http_header_status_store_keyvalue
 };
 
+/**
+ * Initial values for the state parameter of http_parse_header_char.
+ * http_header_initial_fields skips the status line and parses a bare block of
+ * header fields, such as the headers of a multipart body part.
+ */
+enum http_header_initial
+{
+    http_header_initial_status = 0,
+    http_header_initial_fields = 4
+};
+
 /**
  * Parses a single character of an HTTP header stream. The state parameter is
  * used as internal state and should be initialized to zero for the first call.
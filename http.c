@@ -48,7 +48,7 @@ static void grow_scratch(struct http_roundtripper* rt, int size)
     if (nsize < size)
         nsize = size;
 
-	rt->scratch = (char*)rt->funcs.realloc_scratch(rt->opaque, rt->scratch, nsize);
+    rt->scratch = (char*)rt->funcs.realloc_scratch(rt->opaque, rt->scratch, nsize);
     rt->nscratch = nsize;
 }
 
@@ -57,12 +57,19 @@ static int min(int a, int b)
     return a > b ? b : a;
 }
 
+/* 1xx responses other than 101 precede the final response */
+static int is_interim(int code)
+{
+    return code >= 100 && code < 200 && code != 101;
+}
+
 enum http_roundtripper_state {
     http_roundtripper_header,
     http_roundtripper_chunk_header,
     http_roundtripper_chunk_data,
     http_roundtripper_raw_data,
     http_roundtripper_unknown_data,
+    http_roundtripper_trailer,
     http_roundtripper_close,
     http_roundtripper_error,
 };
@@ -96,8 +103,25 @@ int http_data(struct http_roundtripper* rt, const char* data, int size, int* rea
     while (size) {
         switch (rt->state) {
         case http_roundtripper_header:
+        case http_roundtripper_trailer:
             switch (http_parse_header_char(&rt->parsestate, *data)) {
             case http_header_status_done:
+                if (rt->state == http_roundtripper_trailer) {
+                    rt->state = (rt->parsestate != 0) ? http_roundtripper_error : http_roundtripper_close;
+                    break;
+                }
+
+                if (rt->parsestate == 0 && is_interim(rt->code)) {
+                    if (rt->funcs.interim)
+                        rt->funcs.interim(rt->opaque, rt->code);
+                    rt->code = 0;
+                    rt->contentlength = -1;
+                    rt->chunked = 0;
+                    rt->nkey = 0;
+                    rt->nvalue = 0;
+                    break;
+                }
+
                 rt->funcs.code(rt->opaque, rt->code);
                 if (rt->parsestate != 0)
                     rt->state = http_roundtripper_error;
@@ -131,16 +155,20 @@ int http_data(struct http_roundtripper* rt, const char* data, int size, int* rea
                 break;
 
             case http_header_status_store_keyvalue:
-                if (rt->nkey == 17 && 0 == strncmp(rt->scratch, "transfer-encoding", rt->nkey))
-                    rt->chunked = (rt->nvalue == 7 && 0 == strncmp(rt->scratch + rt->nkey, "chunked", rt->nvalue));
-                else if (rt->nkey == 14 && 0 == strncmp(rt->scratch, "content-length", rt->nkey)) {
-                    int ii, end;
-                    rt->contentlength = 0;
-                    for (ii = rt->nkey, end = rt->nkey + rt->nvalue; ii != end; ++ii)
-                        rt->contentlength = rt->contentlength * 10 + rt->scratch[ii] - '0';
+                /* trailers cannot change how the body was framed */
+                if (rt->state == http_roundtripper_header) {
+                    if (rt->nkey == 17 && 0 == strncmp(rt->scratch, "transfer-encoding", rt->nkey))
+                        rt->chunked = (rt->nvalue == 7 && 0 == strncmp(rt->scratch + rt->nkey, "chunked", rt->nvalue));
+                    else if (rt->nkey == 14 && 0 == strncmp(rt->scratch, "content-length", rt->nkey)) {
+                        int ii, end;
+                        rt->contentlength = 0;
+                        for (ii = rt->nkey, end = rt->nkey + rt->nvalue; ii != end; ++ii)
+                            rt->contentlength = rt->contentlength * 10 + rt->scratch[ii] - '0';
+                    }
                 }
 
-                rt->funcs.header(rt->opaque, rt->scratch, rt->nkey, rt->scratch + rt->nkey, rt->nvalue);
+                if (rt->funcs.interim || !is_interim(rt->code))
+                    rt->funcs.header(rt->opaque, rt->scratch, rt->nkey, rt->scratch + rt->nkey, rt->nvalue);
 
                 rt->nkey = 0;
                 rt->nvalue = 0;
@@ -155,9 +183,12 @@ int http_data(struct http_roundtripper* rt, const char* data, int size, int* rea
             if (!http_parse_chunked(&rt->parsestate, &rt->contentlength, *data)) {
                 if (rt->contentlength == -1)
                     rt->state = http_roundtripper_error;
-                else if (rt->contentlength == 0)
-                    rt->state = http_roundtripper_close;
-                else
+                else if (rt->contentlength == 0) {
+                    rt->nkey = 0;
+                    rt->nvalue = 0;
+                    rt->parsestate = http_header_initial_fields;
+                    rt->state = http_roundtripper_trailer;
+                } else
                     rt->state = http_roundtripper_chunk_data;
             }
 
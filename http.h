@@ -39,12 +39,21 @@ extern "C" {
  *  body - handle HTTP response body data
  *  header - handle an HTTP header key/value pair
  *  code - handle the HTTP status code for the response
+ *  interim - optional, handle the status code of an interim (1xx) response.
+ *            Headers passed to the header callback since the previous
+ *            response belong to it. Parsing then continues with the final
+ *            response. If null, interim responses and their headers are
+ *            skipped.
+ *
+ * Trailers following a chunked body are passed to the header callback, after
+ * the status code has been reported.
  */
 struct http_funcs {
     void* (*realloc_scratch)(void* opaque, void* ptr, int size);
     void (*body)(void* opaque, const char* data, int size);
     void (*header)(void* opaque, const char* key, int nkey, const char* value, int nvalue);
     void (*code)(void* opqaue, int code);
+    void (*interim)(void* opaque, int code);
 };
 
 struct http_roundtripper {
@@ -63,7 +72,8 @@ struct http_roundtripper {
 
 /**
  * Initializes a rountripper with the specified response functions. This must
- * be called before the rt object is used.
+ * be called before the rt object is used. The parser keeps no global state, so
+ * independent rt objects may be used concurrently from separate threads.
  */
 void http_init(struct http_roundtripper* rt, struct http_funcs, void* opaque);
 
@@ -0,0 +1,288 @@
+/*-
+ * Copyright 2012 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "multipart.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "header.h"
+
+static void multipart_grow_scratch(struct http_multipart* mp, int size)
+{
+    int nsize;
+    if (mp->nscratch >= size)
+        return;
+
+    if (size < 64)
+        size = 64;
+    nsize = (mp->nscratch * 3) / 2;
+    if (nsize < size)
+        nsize = size;
+
+    mp->scratch = (char*)mp->funcs.realloc_scratch(mp->opaque, mp->scratch, nsize);
+    mp->nscratch = nsize;
+}
+
+static int multipart_prefix(const char* data, int size, const char* lit)
+{
+    int ii;
+    for (ii = 0; lit[ii]; ++ii) {
+        if (ii == size || tolower(data[ii]) != lit[ii])
+            return 0;
+    }
+    return 1;
+}
+
+enum http_multipart_state {
+    http_multipart_preamble,
+    http_multipart_delimiter_end,
+    http_multipart_close_dash,
+    http_multipart_padding,
+    http_multipart_padding_lf,
+    http_multipart_header,
+    http_multipart_part_data,
+    http_multipart_close,
+    http_multipart_error,
+};
+
+int http_multipart_init(struct http_multipart* mp, struct http_multipart_funcs funcs, void* opaque, const char* contenttype, int ncontenttype)
+{
+    const char* end = contenttype + ncontenttype;
+    const char* boundary = 0;
+    int nboundary = 0;
+
+    while (contenttype != end && (*contenttype == ' ' || *contenttype == '\t'))
+        ++contenttype;
+    if (!multipart_prefix(contenttype, end - contenttype, "multipart/"))
+        return 0;
+
+    /* find the boundary parameter, possibly quoted */
+    while (contenttype != end && !boundary) {
+        if (*contenttype++ != ';')
+            continue;
+
+        while (contenttype != end && (*contenttype == ' ' || *contenttype == '\t'))
+            ++contenttype;
+        if (!multipart_prefix(contenttype, end - contenttype, "boundary="))
+            continue;
+
+        contenttype += 9;
+        if (contenttype != end && *contenttype == '"') {
+            boundary = ++contenttype;
+            while (contenttype != end && *contenttype != '"')
+                ++contenttype;
+        } else {
+            boundary = contenttype;
+            while (contenttype != end && *contenttype != ';' && *contenttype != ' ' && *contenttype != '\t')
+                ++contenttype;
+        }
+        nboundary = contenttype - boundary;
+    }
+
+    /* the delimiter scan relies on CR appearing only at its start */
+    if (nboundary == 0 || memchr(boundary, '\r', nboundary) || memchr(boundary, '\n', nboundary))
+        return 0;
+
+    mp->funcs = funcs;
+    mp->opaque = opaque;
+    mp->scratch = 0;
+    mp->parsestate = 0;
+    mp->state = http_multipart_preamble;
+    mp->nscratch = 0;
+    mp->nkey = 0;
+    mp->nvalue = 0;
+
+    /* the first delimiter may start the body without a leading CRLF */
+    mp->ndelimiter = nboundary + 4;
+    mp->nmatched = 2;
+    multipart_grow_scratch(mp, mp->ndelimiter);
+    memcpy(mp->scratch, "\r\n--", 4);
+    memcpy(mp->scratch + 4, boundary, nboundary);
+    return 1;
+}
+
+void http_multipart_free(struct http_multipart* mp)
+{
+    if (mp->scratch) {
+        mp->funcs.realloc_scratch(mp->opaque, mp->scratch, 0);
+        mp->scratch = 0;
+    }
+}
+
+/**
+ * Scans for the next delimiter, optionally passing everything before it to
+ * the body callback. Returns the number of bytes consumed, which ends just
+ * past the delimiter if nmatched reached ndelimiter.
+ */
+static int multipart_scan(struct http_multipart* mp, const char* data, int size, int emit)
+{
+    const char* delimiter = mp->scratch;
+    int ii = 0;
+    while (ii < size) {
+        if (mp->nmatched == 0) {
+            const char* cr = (const char*)memchr(data + ii, '\r', size - ii);
+            const int nrun = cr ? (int)(cr - (data + ii)) : size - ii;
+            if (emit && nrun)
+                mp->funcs.body(mp->opaque, data + ii, nrun);
+            ii += nrun;
+            if (!cr)
+                break;
+        }
+
+        if (data[ii] == delimiter[mp->nmatched]) {
+            ++ii;
+            if (++mp->nmatched == mp->ndelimiter)
+                break;
+        } else {
+            /* the partial match was data. it is also a prefix of the delimiter */
+            if (emit)
+                mp->funcs.body(mp->opaque, delimiter, mp->nmatched);
+            mp->nmatched = 0;
+        }
+    }
+
+    return ii;
+}
+
+int http_multipart_data(struct http_multipart* mp, const char* data, int size, int* read)
+{
+    const int initial_size = size;
+    while (size) {
+        switch (mp->state) {
+        case http_multipart_preamble:
+        case http_multipart_part_data: {
+            const int nscanned = multipart_scan(mp, data, size, mp->state == http_multipart_part_data);
+            size -= nscanned;
+            data += nscanned;
+
+            if (mp->nmatched == mp->ndelimiter) {
+                mp->nmatched = 0;
+                mp->state = http_multipart_delimiter_end;
+            }
+        }
+        break;
+
+        case http_multipart_delimiter_end:
+            if (*data == '-')
+                mp->state = http_multipart_close_dash;
+            else if (*data == ' ' || *data == '\t')
+                mp->state = http_multipart_padding;
+            else if (*data == '\r')
+                mp->state = http_multipart_padding_lf;
+            else
+                mp->state = http_multipart_error;
+
+            --size;
+            ++data;
+            break;
+
+        case http_multipart_close_dash:
+            mp->state = (*data == '-') ? http_multipart_close : http_multipart_error;
+            --size;
+            ++data;
+            break;
+
+        case http_multipart_padding:
+            if (*data == '\r')
+                mp->state = http_multipart_padding_lf;
+            else if (*data != ' ' && *data != '\t')
+                mp->state = http_multipart_error;
+
+            --size;
+            ++data;
+            break;
+
+        case http_multipart_padding_lf:
+            if (*data == '\n') {
+                mp->parsestate = http_header_initial_fields;
+                mp->state = http_multipart_header;
+            } else
+                mp->state = http_multipart_error;
+
+            --size;
+            ++data;
+            break;
+
+        case http_multipart_header:
+            switch (http_parse_header_char(&mp->parsestate, *data)) {
+            case http_header_status_done:
+                if (mp->parsestate != 0)
+                    mp->state = http_multipart_error;
+                else {
+                    mp->nkey = 0;
+                    mp->nvalue = 0;
+                    mp->funcs.part(mp->opaque);
+                    mp->state = http_multipart_part_data;
+                }
+                break;
+
+            case http_header_status_key_character:
+                multipart_grow_scratch(mp, mp->ndelimiter + mp->nkey + 1);
+                mp->scratch[mp->ndelimiter + mp->nkey] = tolower(*data);
+                ++mp->nkey;
+                break;
+
+            case http_header_status_value_character:
+                multipart_grow_scratch(mp, mp->ndelimiter + mp->nkey + mp->nvalue + 1);
+                mp->scratch[mp->ndelimiter + mp->nkey + mp->nvalue] = *data;
+                ++mp->nvalue;
+                break;
+
+            case http_header_status_store_keyvalue: {
+                const char* key = mp->scratch + mp->ndelimiter;
+                mp->funcs.header(mp->opaque, key, mp->nkey, key + mp->nkey, mp->nvalue);
+
+                mp->nkey = 0;
+                mp->nvalue = 0;
+            }
+            break;
+            }
+
+            --size;
+            ++data;
+            break;
+
+        case http_multipart_close:
+        case http_multipart_error:
+            break;
+        }
+
+        if (mp->state == http_multipart_error || mp->state == http_multipart_close) {
+            http_multipart_free(mp);
+            *read = initial_size - size;
+            return 0;
+        }
+    }
+
+    *read = initial_size - size;
+    return 1;
+}
+
+int http_multipart_iserror(struct http_multipart* mp)
+{
+    return mp->state == http_multipart_error;
+}
@@ -0,0 +1,98 @@
+/*-
+ * Copyright 2012 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HTTP_MULTIPART_H
+#define HTTP_MULTIPART_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * Callbacks for handling the parts of a multipart body.
+ *  realloc_scratch - reallocate memory, cannot fail. There will only
+ *                    be one scratch buffer.
+ *  header - handle a key/value pair from the current part's headers
+ *  part - the current part's headers are complete, its data follows
+ *  body - handle data belonging to the current part
+ */
+struct http_multipart_funcs {
+    void* (*realloc_scratch)(void* opaque, void* ptr, int size);
+    void (*header)(void* opaque, const char* key, int nkey, const char* value, int nvalue);
+    void (*part)(void* opaque);
+    void (*body)(void* opaque, const char* data, int size);
+};
+
+struct http_multipart {
+    struct http_multipart_funcs funcs;
+    void *opaque;
+    char *scratch;
+    int parsestate;
+    int state;
+    int nscratch;
+    int ndelimiter;
+    int nmatched;
+    int nkey;
+    int nvalue;
+};
+
+/**
+ * Initializes a multipart parser from the value of a Content-Type header,
+ * such as the one passed to http_funcs.header. Returns non-zero if the value
+ * names a multipart type (e.g. multipart/byteranges or multipart/form-data)
+ * with a boundary parameter. Returns zero otherwise, in which case the mp
+ * object is not used and need not be freed.
+ */
+int http_multipart_init(struct http_multipart* mp, struct http_multipart_funcs funcs, void* opaque, const char* contenttype, int ncontenttype);
+
+/**
+ * Frees any scratch memory allocated during parsing.
+ */
+void http_multipart_free(struct http_multipart* mp);
+
+/**
+ * Parses a block of multipart body data, typically from within
+ * http_funcs.body. Part headers and data are streamed to the callbacks as they
+ * arrive, so memory use does not depend on part sizes. Returns zero if the
+ * parser reached the closing boundary, or an error was encountered. Use
+ * http_multipart_iserror to check for the presence of an error. Any epilogue
+ * following the closing boundary is left unread. Returns non-zero if more data
+ * is required.
+ */
+int http_multipart_data(struct http_multipart* mp, const char* data, int size, int* read);
+
+/**
+ * Returns non-zero if a completed parser encounted an error. If
+ * http_multipart_data did not return zero, the results of this function are
+ * undefined.
+ */
+int http_multipart_iserror(struct http_multipart* mp);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif